@@ -159,7 +159,11 @@ PROTECTED_MODE_BEGIN:
   ; Jump to the address where we loaded the kernel
   call KERNEL_ORIGIN_ADDRESS
 
-  jmp $
+  ; Sleep rather than spin if the kernel ever returns. Interrupts are
+  ; still disabled, so only an NMI can take us out of "hlt"
+.halt:
+  hlt
+  jmp .halt
 
 ; ---------------------------------------------------------------------
 ; Messages
@@ -26,8 +26,89 @@
 ; its ocurrences.
 [extern main]
 
-; Lets jump to the entry point of the kernel
-call main
+; Export the address of the first instruction of the kernel, so
+; the C code can tell where the kernel code starts in memory
+[global kernel_entry]
 
-; An infinite loop, as we should never continue from here
-jmp $
+; Export the Multiboot entry point, so the linker can record it
+; as the entry point of the ELF copy of the kernel
+[global multiboot_entry]
+
+; This must be the first instruction, as our boot
+; loader jumps to the beginning of the kernel
+kernel_entry:
+  ; Lets jump to the entry point of the kernel. Our boot loader
+  ; doesn't pass any Multiboot magic value or information
+  push dword 0
+  push dword 0
+  call main
+  jmp kernel_idle
+
+; ---------------------------------------------------------------------
+; Multiboot
+; ---------------------------------------------------------------------
+;
+; Besides our own boot loader, the kernel can be booted by any
+; Multiboot compliant boot loader, such as GRUB or QEMU's "-kernel"
+; option, which skips the BIOS boot sector and the floppy reads.
+; See https://www.gnu.org/software/grub/manual/multiboot/multiboot.html
+;
+; A Multiboot boot loader jumps to the kernel in 32-bit protected mode,
+; with the MULTIBOOT_BOOTLOADER_MAGIC value in EAX and the address of
+; the Multiboot information structure in EBX. There is no stack, and
+; we can't trust the GDT, so we have to set up both ourselves.
+
+%define MULTIBOOT_HEADER_MAGIC 0x1badb002
+
+; Ask for the memory information (bit 1)
+%define MULTIBOOT_HEADER_FLAGS 0x00000002
+
+; The same stack address that our boot loader uses
+%define MULTIBOOT_STACK_ADDRESS 0x90000
+
+; The selectors of the flat model GDT that we include below
+%define SEGMENT_CODE (gdt_code - gdt_start)
+%define SEGMENT_DATA (gdt_data - gdt_start)
+
+multiboot_entry:
+  ; Load our GDT and reload all the segment registers from it,
+  ; without touching EAX and EBX
+  lgdt [gdt_descriptor]
+  jmp SEGMENT_CODE:multiboot_segments
+multiboot_segments:
+  mov cx, SEGMENT_DATA
+  mov ds, cx
+  mov ss, cx
+  mov es, cx
+  mov fs, cx
+  mov gs, cx
+
+  mov esp, MULTIBOOT_STACK_ADDRESS
+  mov ebp, esp
+
+  ; Pass the Multiboot magic value and information structure
+  ; address to the entry point of the kernel
+  push ebx
+  push eax
+  call main
+
+; There is nothing else to do once the kernel returns, so we idle.
+; An infinite "jmp $" loop would keep the CPU (and, when virtualised,
+; a whole host core) busy doing nothing. The "hlt" instruction instead
+; stops the CPU until the next interrupt arrives. We still loop, as an
+; interrupt (i.e. an NMI) resumes execution right after "hlt"
+kernel_idle:
+  hlt
+  jmp kernel_idle
+
+; The boot loader looks for this header in the first 8 KiB of
+; the kernel image, aligned to a 4-byte boundary
+align 4
+multiboot_header:
+  dd MULTIBOOT_HEADER_MAGIC
+  dd MULTIBOOT_HEADER_FLAGS
+  ; The three fields must add up to zero
+  dd -(MULTIBOOT_HEADER_MAGIC + MULTIBOOT_HEADER_FLAGS)
+
+; The same flat model GDT that our boot loader uses
+%include "utils/gdt.asm"
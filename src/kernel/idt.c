@@ -0,0 +1,84 @@
+/* Copyright (c) 2018, Juan Cruz Viotti
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *     # derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "idt.h"
+
+// Present, ring 0, 32-bit interrupt gate. Interrupt gates (as opposed
+// to trap gates) clear the interrupt flag while the handler runs
+static const byte_t IDT_GATE_INTERRUPT = 0x8e;
+
+typedef struct idt_descriptor
+{
+  word_t size;
+  dword_t address;
+} __attribute__((packed)) idt_descriptor_t;
+
+static idt_gate_t idt[IDT_ENTRIES];
+
+idt_gate_t idt_gate(const dword_t handler, const word_t selector)
+{
+  idt_gate_t gate;
+  gate.offset_low = (word_t) (handler & 0xffff);
+  gate.selector = selector;
+  gate.zero = 0;
+  gate.attributes = IDT_GATE_INTERRUPT;
+  gate.offset_high = (word_t) (handler >> 16);
+  return gate;
+}
+
+// Impure
+void idt_init()
+{
+  memory_set((byte_t *) idt, 0, sizeof(idt));
+
+  idt_descriptor_t descriptor;
+  descriptor.size = sizeof(idt) - 1;
+  descriptor.address = (dword_t) (uintptr_t) idt;
+  __asm__ __volatile__("lidt %0" : : "m" (descriptor));
+}
+
+// Impure
+void idt_set_gate(const byte_t vector, void (* const handler)())
+{
+  // Handlers run on the code segment we are running on right now,
+  // whoever set it up
+  word_t selector;
+  __asm__("mov %%cs, %0" : "=r" (selector));
+
+  idt[vector] = idt_gate((dword_t) (uintptr_t) handler, selector);
+}
+
+// Impure
+void idt_enable_interrupts()
+{
+  __asm__ __volatile__("sti");
+}
+
+// Impure
+void idt_disable_interrupts()
+{
+  __asm__ __volatile__("cli");
+}
@@ -0,0 +1,72 @@
+#ifndef KERNEL_IDT_H
+#define KERNEL_IDT_H
+
+/* Copyright (c) 2018, Juan Cruz Viotti
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *     # derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdint.h>
+#include "types.h"
+#include "memory.h"
+
+/**
+ * The Interrupt Descriptor Table (IDT) tells the CPU where to jump
+ * to on every interrupt or exception vector. It is the protected mode
+ * counterpart of the real mode interrupt vector table that the BIOS
+ * sets up at address 0x0, which we can't use anymore.
+ */
+
+#define IDT_ENTRIES 256
+
+typedef struct idt_gate
+{
+  word_t offset_low;
+  word_t selector;
+  byte_t zero;
+  byte_t attributes;
+  word_t offset_high;
+} __attribute__((packed)) idt_gate_t;
+
+/**
+ * Encode a 32-bit interrupt gate to the given handler,
+ * running on the given code segment
+ */
+idt_gate_t idt_gate(const dword_t handler, const word_t selector);
+
+/**
+ * Clear the table and load it into the CPU. Every vector starts as
+ * not present, so an unexpected interrupt still takes the machine down
+ */
+void idt_init();
+
+/**
+ * Point an interrupt vector at a handler
+ */
+void idt_set_gate(const byte_t vector, void (* const handler)());
+
+void idt_enable_interrupts();
+void idt_disable_interrupts();
+
+#endif
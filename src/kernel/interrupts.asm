@@ -0,0 +1,40 @@
+; ---------------------------------------------------------------------
+; Interrupt Handlers
+; ---------------------------------------------------------------------
+;
+; The CPU jumps to an interrupt handler in the middle of whatever code
+; was running, so a handler must preserve every register and return
+; with "iret" rather than "ret", which also restores the flags and the
+; code segment that the CPU pushed to the stack. We can't do either
+; from C, so the IDT points to these small wrappers instead, which
+; call the C code as a normal function.
+
+[bits 32]
+
+[global interrupt_ignore]
+
+; Swallow interrupts we don't care about, i.e. spurious IRQs
+interrupt_ignore:
+  iret
+
+; Only profiling builds handle the timer interrupt
+%if PROFILER
+[global interrupt_timer]
+[extern profiler_interrupt]
+
+interrupt_timer:
+  ; Push all the general purpose registers to the stack
+  pusha
+  ; The C calling convention expects the direction flag to be clear
+  cld
+
+  ; The CPU pushed the address of the interrupted instruction right
+  ; before the registers we just pushed (8 registers, 4 bytes each).
+  ; Pass it as the first argument
+  push dword [esp + 32]
+  call profiler_interrupt
+  add esp, 4
+
+  popa
+  iret
+%endif
@@ -25,9 +25,214 @@
  */
 
 #include "screen.h"
+#include "idt.h"
+#include "pic.h"
+#include "interrupts.h"
+#include "multiboot.h"
+#include "profiler.h"
+#include "virtio_blk.h"
 
-void main()
+// The first instruction of the kernel, defined in entry.asm
+void kernel_entry();
+
+// The virtio-blk benchmark reads this many requests of this many
+// sectors into a scratch buffer, at each of the queue depths below
+#define BENCHMARK_REQUESTS 512
+#define BENCHMARK_REQUEST_SECTORS 8
+#define BENCHMARK_BUFFER_ADDRESS 0x20000
+
+// Give up on a run after this many cycles (about 20 seconds at
+// 3 GHz), so a device that stops answering can't hang the boot
+#define BENCHMARK_TIMEOUT_CYCLES 0x1000000000ull
+
+static const int32_t BENCHMARK_DEPTHS[] = { 1, 4, 16, 64 };
+
+// The CPU's time-stamp counter, in cycles
+static inline uint64_t __main_timestamp()
+{
+  dword_t low;
+  dword_t high;
+  __asm__ __volatile__("rdtsc" : "=a" (low), "=d" (high));
+  return ((uint64_t) high << 32) | low;
+}
+
+// Returns 1 if the run completed, or 0 if it timed out
+static int32_t __main_virtio_blk_benchmark(
+  virtio_blk_device_t * const device, const int32_t depth)
+{
+  virtio_blk_request_t batch[VIRTIO_BLK_MAX_DEPTH];
+  int32_t submitted = 0;
+  int32_t completed = 0;
+  uint64_t sector = 0;
+
+  const uint64_t start = __main_timestamp();
+  while (completed < BENCHMARK_REQUESTS)
+  {
+    // Top the queue up to the desired depth in a single batch
+    const int32_t in_flight = submitted - completed;
+    int32_t count = depth - in_flight;
+    if (count > BENCHMARK_REQUESTS - submitted)
+    {
+      count = BENCHMARK_REQUESTS - submitted;
+    }
+
+    int32_t index;
+    for (index = 0; index < count; index++)
+    {
+      if (sector + BENCHMARK_REQUEST_SECTORS > device->capacity)
+      {
+        sector = 0;
+      }
+
+      batch[index].type = VIRTIO_BLK_TYPE_IN;
+      batch[index].sector = sector;
+      batch[index].buffer = (byte_t *) BENCHMARK_BUFFER_ADDRESS;
+      batch[index].sectors = BENCHMARK_REQUEST_SECTORS;
+      sector += BENCHMARK_REQUEST_SECTORS;
+    }
+
+    submitted += virtio_blk_submit(device, batch, count);
+    completed += virtio_blk_poll(device);
+
+    if (__main_timestamp() - start > BENCHMARK_TIMEOUT_CYCLES)
+    {
+      break;
+    }
+  }
+
+  const uint64_t cycles = __main_timestamp() - start;
+
+  screen_print("virtio-blk depth ", ATTRIBUTE_WHITE_ON_BLACK);
+  screen_print_hex((dword_t) depth, ATTRIBUTE_WHITE_ON_BLACK);
+  screen_print(": ", ATTRIBUTE_WHITE_ON_BLACK);
+
+  if (completed < BENCHMARK_REQUESTS)
+  {
+    screen_print("timed out after ", ATTRIBUTE_WHITE_ON_BLACK);
+    screen_print_hex((dword_t) completed, ATTRIBUTE_WHITE_ON_BLACK);
+    screen_print(" reads\n", ATTRIBUTE_WHITE_ON_BLACK);
+    return 0;
+  }
+
+  screen_print_hex(BENCHMARK_REQUESTS, ATTRIBUTE_WHITE_ON_BLACK);
+  screen_print(" reads in ", ATTRIBUTE_WHITE_ON_BLACK);
+
+  // The count can take more than 32 bits, so we
+  // print the high and low double words in turn
+  screen_print_hex((dword_t) (cycles >> 32), ATTRIBUTE_WHITE_ON_BLACK);
+  screen_print(":", ATTRIBUTE_WHITE_ON_BLACK);
+  screen_print_hex((dword_t) cycles, ATTRIBUTE_WHITE_ON_BLACK);
+  screen_print(" cycles\n", ATTRIBUTE_WHITE_ON_BLACK);
+  return 1;
+}
+
+static void __main_virtio_blk()
+{
+  virtio_blk_device_t device;
+  if (virtio_blk_init(&device) == 0
+    || device.capacity < BENCHMARK_REQUEST_SECTORS)
+  {
+    return;
+  }
+
+  screen_print("virtio-blk sectors: ", ATTRIBUTE_WHITE_ON_BLACK);
+  screen_print_hex((dword_t) device.capacity, ATTRIBUTE_WHITE_ON_BLACK);
+  screen_print("\n", ATTRIBUTE_WHITE_ON_BLACK);
+
+  int32_t index;
+  for (index = 0;
+    index < (int32_t) (sizeof(BENCHMARK_DEPTHS) / sizeof(BENCHMARK_DEPTHS[0]));
+    index++)
+  {
+    // The requests of a run that timed out are still in
+    // flight, so we can't trust the device for the next one
+    if (BENCHMARK_DEPTHS[index] <= device.depth
+      && __main_virtio_blk_benchmark(&device, BENCHMARK_DEPTHS[index]) == 0)
+    {
+      break;
+    }
+  }
+
+  if (device.errors > 0)
+  {
+    screen_print("virtio-blk errors: ", ATTRIBUTE_WHITE_ON_BLACK);
+    screen_print_hex((dword_t) device.errors, ATTRIBUTE_WHITE_ON_BLACK);
+    screen_print("\n", ATTRIBUTE_WHITE_ON_BLACK);
+  }
+}
+
+static void __main_multiboot(const multiboot_info_t * const info)
 {
+  screen_print("Booted by Multiboot\n", ATTRIBUTE_WHITE_ON_BLACK);
+
+  if (info->flags & MULTIBOOT_INFO_CMDLINE)
+  {
+    screen_print("Command line: ", ATTRIBUTE_WHITE_ON_BLACK);
+    screen_print((const char *) (uintptr_t) info->cmdline, ATTRIBUTE_WHITE_ON_BLACK);
+    screen_print("\n", ATTRIBUTE_WHITE_ON_BLACK);
+  }
+
+  if (info->flags & MULTIBOOT_INFO_MEMORY_MAP)
+  {
+    screen_print("Available memory (KiB): ", ATTRIBUTE_WHITE_ON_BLACK);
+    screen_print_hex(multiboot_memory_map_available(
+      (const byte_t *) (uintptr_t) info->memory_map_address,
+      info->memory_map_length), ATTRIBUTE_WHITE_ON_BLACK);
+    screen_print("\n", ATTRIBUTE_WHITE_ON_BLACK);
+  }
+  else if (info->flags & MULTIBOOT_INFO_MEMORY)
+  {
+    screen_print("Available memory (KiB): ", ATTRIBUTE_WHITE_ON_BLACK);
+    screen_print_hex(info->memory_lower + info->memory_upper, ATTRIBUTE_WHITE_ON_BLACK);
+    screen_print("\n", ATTRIBUTE_WHITE_ON_BLACK);
+  }
+}
+
+void main(const dword_t multiboot_magic, const multiboot_info_t * const multiboot_info)
+{
+  // Move the IRQs away from the CPU exception vectors, and ignore
+  // all of them, except for the timer on profiling builds, which
+  // feeds the profiler. The PIC keeps the rest masked anyways
+  idt_init();
+  pic_init();
+  byte_t irq;
+  for (irq = 0; irq < PIC_IRQS; irq++)
+  {
+    idt_set_gate(PIC_VECTOR_OFFSET + irq, interrupt_ignore);
+  }
+
+#if PROFILER
+  idt_set_gate(PIC_VECTOR_OFFSET + PIC_IRQ_TIMER, interrupt_timer);
+#endif
+
+  idt_enable_interrupts();
+
+#if PROFILER
+  // Profile the rest of the boot. Notice the sampling interrupts
+  // inflate the cycle counts of the virtio-blk benchmark
+  profiler_start((dword_t) (uintptr_t) kernel_entry);
+#endif
+
   screen_clear();
   screen_print("> Welcome to SimpleOS!\n", ATTRIBUTE_WHITE_ON_BLUE);
+
+  // Read the Multiboot information before we
+  // reuse any memory that might be holding it
+  if (multiboot_magic == MULTIBOOT_BOOTLOADER_MAGIC)
+  {
+    __main_multiboot(multiboot_info);
+  }
+
+  __main_virtio_blk();
+
+#if PROFILER
+  // This also disarms the timer, so nothing
+  // wakes up the CPU once we go idle
+  profiler_stop();
+  profiler_dump();
+#else
+  // There is no pending work, so disarm the periodic tick that
+  // the BIOS left running, and let the CPU sleep once we go idle
+  timer_stop();
+#endif
 }
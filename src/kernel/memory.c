@@ -37,3 +37,15 @@ void memory_copy(
     *(destination + index) = *(source + index);
   }
 }
+
+void memory_set(
+    byte_t * const destination,
+    const byte_t value,
+    const int32_t bytes)
+{
+  int32_t index;
+  for (index = 0; index < bytes; index++)
+  {
+    *(destination + index) = value;
+  }
+}
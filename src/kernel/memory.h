@@ -35,4 +35,9 @@ void memory_copy(
     byte_t * const destination,
     const int32_t bytes);
 
+void memory_set(
+    byte_t * const destination,
+    const byte_t value,
+    const int32_t bytes);
+
 #endif
@@ -0,0 +1,88 @@
+#ifndef KERNEL_MULTIBOOT_H
+#define KERNEL_MULTIBOOT_H
+
+/* Copyright (c) 2018, Juan Cruz Viotti
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *     # derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdint.h>
+#include "types.h"
+
+/**
+ * The information that a Multiboot compliant boot loader passes
+ * to the kernel. See entry.asm.
+ */
+
+// The value in EAX when a Multiboot boot loader started us
+#define MULTIBOOT_BOOTLOADER_MAGIC 0x2badb002
+
+// Which fields of the information structure are valid
+#define MULTIBOOT_INFO_MEMORY 0x001
+#define MULTIBOOT_INFO_CMDLINE 0x004
+#define MULTIBOOT_INFO_MEMORY_MAP 0x040
+
+// The memory map type of usable RAM
+#define MULTIBOOT_MEMORY_AVAILABLE 1
+
+typedef struct multiboot_info
+{
+  dword_t flags;
+
+  // Amount of lower and upper memory, in KiB
+  dword_t memory_lower;
+  dword_t memory_upper;
+
+  dword_t boot_device;
+
+  // The address of a null-terminated string
+  dword_t cmdline;
+
+  dword_t modules_count;
+  dword_t modules_address;
+  dword_t symbols[4];
+
+  // The address and size in bytes of a buffer of memory map entries
+  dword_t memory_map_length;
+  dword_t memory_map_address;
+} __attribute__((packed)) multiboot_info_t;
+
+typedef struct multiboot_memory_map_entry
+{
+  // The size of the rest of the entry, which might be
+  // larger than the fields that we know about
+  dword_t size;
+  uint64_t address;
+  uint64_t length;
+  dword_t type;
+} __attribute__((packed)) multiboot_memory_map_entry_t;
+
+/**
+ * Walk a memory map buffer and get the amount of available
+ * memory, in KiB
+ */
+dword_t multiboot_memory_map_available(
+  const byte_t * const memory_map, const dword_t length);
+
+#endif
@@ -0,0 +1,117 @@
+/* Copyright (c) 2018, Juan Cruz Viotti
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *     # derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "pci.h"
+
+// Configuration mechanism #1 I/O ports
+static const port_t REGISTRY_PCI_CONFIG_ADDRESS = 0xCF8;
+static const port_t REGISTRY_PCI_CONFIG_DATA = 0xCFC;
+
+static const int32_t PCI_BUSES = 256;
+static const int32_t PCI_SLOTS = 32;
+static const int32_t PCI_FUNCTIONS = 8;
+
+dword_t pci_config_address(const pci_device_t device, const byte_t offset)
+{
+  // Bit 31 enables the access, and the rest of the bits encode
+  // the bus, slot, function, and register numbers
+  return 0x80000000u
+    | ((dword_t) device.bus << 16)
+    | ((dword_t) (device.slot & 0x1f) << 11)
+    | ((dword_t) (device.function & 0x07) << 8)
+    | (dword_t) (offset & 0xfc);
+}
+
+// Impure
+dword_t pci_config_read_dword(const pci_device_t device, const byte_t offset)
+{
+  port_dword_out(REGISTRY_PCI_CONFIG_ADDRESS, pci_config_address(device, offset));
+  return port_dword_in(REGISTRY_PCI_CONFIG_DATA);
+}
+
+// Impure
+word_t pci_config_read_word(const pci_device_t device, const byte_t offset)
+{
+  const dword_t value = pci_config_read_dword(device, offset);
+  return (word_t) (value >> ((offset & 0x2) * 8));
+}
+
+// Impure
+void pci_config_write_word(
+  const pci_device_t device, const byte_t offset, const word_t value)
+{
+  // The data port is a double word wide, but we can access
+  // its individual words by offseting the port number
+  port_dword_out(REGISTRY_PCI_CONFIG_ADDRESS, pci_config_address(device, offset));
+  port_word_out((port_t) (REGISTRY_PCI_CONFIG_DATA + (offset & 0x2)), value);
+}
+
+// Impure
+int32_t pci_find_device(
+  const word_t vendor_id, const word_t device_id, pci_device_t * const result)
+{
+  int32_t bus;
+  int32_t slot;
+  int32_t function;
+
+  for (bus = 0; bus < PCI_BUSES; bus++)
+  {
+    for (slot = 0; slot < PCI_SLOTS; slot++)
+    {
+      // Every configuration access is a pair of port writes and
+      // reads, which are expensive when virtualised, so we only
+      // probe the other functions of multi-function devices
+      int32_t functions = 1;
+
+      for (function = 0; function < functions; function++)
+      {
+        const pci_device_t device = { (byte_t) bus, (byte_t) slot, (byte_t) function };
+
+        const word_t vendor = pci_config_read_word(device, PCI_CONFIG_VENDOR_ID);
+        if (vendor == PCI_VENDOR_NONE)
+        {
+          continue;
+        }
+
+        if (function == 0
+          && (pci_config_read_word(device, PCI_CONFIG_HEADER_TYPE)
+            & PCI_HEADER_TYPE_MULTIFUNCTION))
+        {
+          functions = PCI_FUNCTIONS;
+        }
+
+        if (vendor == vendor_id
+          && pci_config_read_word(device, PCI_CONFIG_DEVICE_ID) == device_id)
+        {
+          *result = device;
+          return 1;
+        }
+      }
+    }
+  }
+
+  return 0;
+}
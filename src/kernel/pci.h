@@ -0,0 +1,86 @@
+#ifndef KERNEL_PCI_H
+#define KERNEL_PCI_H
+
+/* Copyright (c) 2018, Juan Cruz Viotti
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *     # derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdint.h>
+#include "port.h"
+#include "types.h"
+
+/**
+ * A set of utilities to access the PCI configuration space
+ * through the legacy "configuration mechanism #1" I/O ports.
+ */
+
+// Offsets into the standard configuration space header
+#define PCI_CONFIG_VENDOR_ID 0x00
+#define PCI_CONFIG_DEVICE_ID 0x02
+#define PCI_CONFIG_COMMAND 0x04
+#define PCI_CONFIG_HEADER_TYPE 0x0e
+#define PCI_CONFIG_BAR0 0x10
+
+// Bits of the command register
+#define PCI_COMMAND_IO_SPACE 0x1
+#define PCI_COMMAND_BUS_MASTER 0x4
+
+// Set on base address registers that map I/O space rather than memory
+#define PCI_BAR_IO_SPACE 0x1
+
+// The vendor id of an empty slot
+#define PCI_VENDOR_NONE 0xffff
+
+// Set on the header type of devices implementing more than one function
+#define PCI_HEADER_TYPE_MULTIFUNCTION 0x80
+
+typedef struct pci_device
+{
+  byte_t bus;
+  byte_t slot;
+  byte_t function;
+} pci_device_t;
+
+/**
+ * Get the value to write to the configuration address port
+ * in order to access a double word of a device's configuration
+ * space. The offset is rounded down to a double word boundary
+ */
+dword_t pci_config_address(const pci_device_t device, const byte_t offset);
+
+dword_t pci_config_read_dword(const pci_device_t device, const byte_t offset);
+word_t pci_config_read_word(const pci_device_t device, const byte_t offset);
+void pci_config_write_word(
+  const pci_device_t device, const byte_t offset, const word_t value);
+
+/**
+ * Scan the buses for the first function with the given vendor
+ * and device ids. Returns 1 and fills the result if found, or
+ * 0 otherwise
+ */
+int32_t pci_find_device(
+  const word_t vendor_id, const word_t device_id, pci_device_t * const result);
+
+#endif
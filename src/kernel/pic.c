@@ -0,0 +1,92 @@
+/* Copyright (c) 2018, Juan Cruz Viotti
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *     # derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "pic.h"
+
+// PIC I/O ports
+static const port_t REGISTRY_PIC_MASTER_COMMAND = 0x20;
+static const port_t REGISTRY_PIC_MASTER_DATA = 0x21;
+static const port_t REGISTRY_PIC_SLAVE_COMMAND = 0xa0;
+static const port_t REGISTRY_PIC_SLAVE_DATA = 0xa1;
+
+// Initialisation command words
+static const byte_t PIC_ICW1_INIT = 0x11;
+static const byte_t PIC_ICW3_MASTER = 0x04;
+static const byte_t PIC_ICW3_SLAVE = 0x02;
+static const byte_t PIC_ICW4_8086 = 0x01;
+
+static const byte_t PIC_END_OF_INTERRUPT = 0x20;
+
+// The IRQ line of the master on which the slave is cascaded
+static const byte_t PIC_IRQ_CASCADE = 2;
+
+static port_t __pic_data_port(const byte_t irq)
+{
+  return irq < 8 ? REGISTRY_PIC_MASTER_DATA : REGISTRY_PIC_SLAVE_DATA;
+}
+
+// Impure
+void pic_init()
+{
+  port_byte_out(REGISTRY_PIC_MASTER_COMMAND, PIC_ICW1_INIT);
+  port_byte_out(REGISTRY_PIC_SLAVE_COMMAND, PIC_ICW1_INIT);
+  port_byte_out(REGISTRY_PIC_MASTER_DATA, PIC_VECTOR_OFFSET);
+  port_byte_out(REGISTRY_PIC_SLAVE_DATA, PIC_VECTOR_OFFSET + 8);
+  port_byte_out(REGISTRY_PIC_MASTER_DATA, PIC_ICW3_MASTER);
+  port_byte_out(REGISTRY_PIC_SLAVE_DATA, PIC_ICW3_SLAVE);
+  port_byte_out(REGISTRY_PIC_MASTER_DATA, PIC_ICW4_8086);
+  port_byte_out(REGISTRY_PIC_SLAVE_DATA, PIC_ICW4_8086);
+
+  // Leave only the cascade line open, so unmasking
+  // an IRQ on the slave is enough to get it delivered
+  port_byte_out(REGISTRY_PIC_MASTER_DATA, (byte_t) ~(1 << PIC_IRQ_CASCADE));
+  port_byte_out(REGISTRY_PIC_SLAVE_DATA, 0xff);
+}
+
+// Impure
+void pic_mask(const byte_t irq)
+{
+  const port_t port = __pic_data_port(irq);
+  port_byte_out(port, (byte_t) (port_byte_in(port) | (1 << (irq % 8))));
+}
+
+// Impure
+void pic_unmask(const byte_t irq)
+{
+  const port_t port = __pic_data_port(irq);
+  port_byte_out(port, (byte_t) (port_byte_in(port) & ~(1 << (irq % 8))));
+}
+
+// Impure
+void pic_end_of_interrupt(const byte_t irq)
+{
+  if (irq >= 8)
+  {
+    port_byte_out(REGISTRY_PIC_SLAVE_COMMAND, PIC_END_OF_INTERRUPT);
+  }
+
+  port_byte_out(REGISTRY_PIC_MASTER_COMMAND, PIC_END_OF_INTERRUPT);
+}
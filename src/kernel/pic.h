@@ -0,0 +1,59 @@
+#ifndef KERNEL_PIC_H
+#define KERNEL_PIC_H
+
+/* Copyright (c) 2018, Juan Cruz Viotti
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *     # derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "port.h"
+#include "types.h"
+
+/**
+ * A driver for the pair of cascaded 8259 Programmable Interrupt
+ * Controllers (PIC) that deliver the legacy hardware IRQs.
+ */
+
+#define PIC_IRQS 16
+
+// Where we move the IRQs to. The BIOS maps the first 8 IRQs on top
+// of the vectors that protected mode reserves for CPU exceptions
+#define PIC_VECTOR_OFFSET 0x20
+
+#define PIC_IRQ_TIMER 0
+
+/**
+ * Remap the IRQs to PIC_VECTOR_OFFSET, and mask all of them
+ */
+void pic_init();
+
+void pic_mask(const byte_t irq);
+void pic_unmask(const byte_t irq);
+
+/**
+ * Acknowledge an IRQ, so the PIC can deliver the next one
+ */
+void pic_end_of_interrupt(const byte_t irq);
+
+#endif
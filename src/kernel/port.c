@@ -58,3 +58,15 @@ void port_word_out(const port_t port, const word_t value)
 {
   __asm__("out %%ax, %%dx" : : "a" (value), "d" (port));
 }
+
+dword_t port_dword_in(const port_t port)
+{
+  dword_t result;
+  __asm__("in %%dx, %%eax" : "=a" (result) : "d" (port));
+  return result;
+}
+
+void port_dword_out(const port_t port, const dword_t value)
+{
+  __asm__("out %%eax, %%dx" : : "a" (value), "d" (port));
+}
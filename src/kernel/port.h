@@ -58,4 +58,14 @@ word_t port_word_in(const port_t port);
  */
 void port_word_out(const port_t port, const word_t value);
 
+/**
+ * Read a double word from a port
+ */
+dword_t port_dword_in(const port_t port);
+
+/**
+ * Write a double word to a port
+ */
+void port_dword_out(const port_t port, const dword_t value);
+
 #endif
@@ -0,0 +1,121 @@
+/* Copyright (c) 2018, Juan Cruz Viotti
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *     # derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "profiler.h"
+
+#if PROFILER
+static dword_t histogram[PROFILER_BUCKETS];
+
+// Samples that landed outside the kernel code
+static dword_t histogram_outside;
+
+static dword_t profiler_text_address;
+static volatile int32_t profiler_running = 0;
+#endif
+
+int32_t profiler_bucket(const dword_t text_address, const dword_t address)
+{
+  if (address < text_address || address - text_address >= PROFILER_TEXT_SIZE)
+  {
+    return -1;
+  }
+
+  return (int32_t) ((address - text_address) / PROFILER_BUCKET_SIZE);
+}
+
+#if PROFILER
+// Impure
+void profiler_start(const dword_t text_address)
+{
+  memory_set((byte_t *) histogram, 0, sizeof(histogram));
+  histogram_outside = 0;
+  profiler_text_address = text_address;
+  profiler_running = 1;
+
+  // Program the timer before unmasking it. An IRQ left pending by the
+  // BIOS tick would otherwise run the handler, which re-arms the
+  // timer, halfway through our own command and count writes
+  timer_oneshot(PROFILER_INTERVAL);
+  pic_unmask(PIC_IRQ_TIMER);
+}
+
+// Impure
+void profiler_stop()
+{
+  profiler_running = 0;
+  timer_stop();
+  pic_mask(PIC_IRQ_TIMER);
+}
+
+// Impure
+void profiler_interrupt(const dword_t address)
+{
+  const int32_t bucket = profiler_bucket(profiler_text_address, address);
+  if (bucket < 0)
+  {
+    histogram_outside++;
+  }
+  else
+  {
+    histogram[bucket]++;
+  }
+
+  pic_end_of_interrupt(PIC_IRQ_TIMER);
+
+  // Only arm the next deadline if we still want samples
+  if (profiler_running)
+  {
+    timer_oneshot(PROFILER_INTERVAL);
+  }
+}
+
+// Impure
+void profiler_dump()
+{
+  debug_print("profile ");
+  debug_print_hex(profiler_text_address);
+  debug_print(" ");
+  debug_print_hex(PROFILER_BUCKET_SIZE);
+  debug_print("\n");
+
+  int32_t bucket;
+  for (bucket = 0; bucket < PROFILER_BUCKETS; bucket++)
+  {
+    if (histogram[bucket] > 0)
+    {
+      debug_print_hex(
+        profiler_text_address + (dword_t) bucket * PROFILER_BUCKET_SIZE);
+      debug_print(" ");
+      debug_print_hex(histogram[bucket]);
+      debug_print("\n");
+    }
+  }
+
+  debug_print("outside ");
+  debug_print_hex(histogram_outside);
+  debug_print("\n");
+}
+#endif
@@ -0,0 +1,88 @@
+#ifndef KERNEL_PROFILER_H
+#define KERNEL_PROFILER_H
+
+/* Copyright (c) 2018, Juan Cruz Viotti
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *     # derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdint.h>
+#include "types.h"
+#include "memory.h"
+#include "debug.h"
+#include "pic.h"
+#include "timer.h"
+
+/**
+ * A sampling profiler. Every PROFILER_INTERVAL PIT ticks, the timer
+ * interrupt records the address of the interrupted instruction on a
+ * histogram covering the kernel code, which we can then dump over the
+ * debug channel and symbolise on the host with test/profile.sh.
+ *
+ * The timer is re-armed as a one-shot from the interrupt itself, so
+ * it stops ticking as soon as the profiler stops.
+ */
+
+// The kernel can't be larger than what the boot loader loads.
+// KERNEL_DISK_SIZE comes from the Makefile, in bits
+#define PROFILER_TEXT_SIZE (KERNEL_DISK_SIZE / 8)
+
+// The number of bytes of code that a histogram bucket covers
+#define PROFILER_BUCKET_SIZE 8
+
+#define PROFILER_BUCKETS (PROFILER_TEXT_SIZE / PROFILER_BUCKET_SIZE)
+
+// About 10 kHz
+#define PROFILER_INTERVAL 119
+
+/**
+ * Get the histogram bucket of an address, given the address where
+ * the kernel code starts, or -1 if the address is out of range
+ */
+int32_t profiler_bucket(const dword_t text_address, const dword_t address);
+
+// The rest of the profiler only exists on profiling builds,
+// so that other kernels don't carry its histogram around
+#if PROFILER
+/**
+ * Clear the histogram and start sampling. The timer interrupt must
+ * be routed to interrupt_timer, and interrupts must be enabled
+ */
+void profiler_start(const dword_t text_address);
+
+void profiler_stop();
+
+/**
+ * Record a sample. Called from the timer interrupt
+ */
+void profiler_interrupt(const dword_t address);
+
+/**
+ * Write the non-empty buckets to the debug channel, one per line,
+ * as the address where the bucket starts followed by its samples
+ */
+void profiler_dump();
+#endif
+
+#endif
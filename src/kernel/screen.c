@@ -88,6 +88,13 @@ void screen_print(const char * const message, const byte_t attributes)
   screen_print_at(message, -1, -1, attributes);
 }
 
+void screen_print_hex(const dword_t value, const byte_t attributes)
+{
+  char message[HEX_BUFFER_SIZE];
+  hex_format(value, message);
+  screen_print(message, attributes);
+}
+
 void screen_clear()
 {
   byte_t * const address = (byte_t * const) VGA_VIDEO_ADDRESS;
@@ -29,6 +29,7 @@
 
 #include <stdint.h>
 #include "vga.h"
+#include "hex.h"
 
 #define ATTRIBUTE_WHITE_ON_BLACK 0x0f
 #define ATTRIBUTE_WHITE_ON_BLUE 0x1f
@@ -43,6 +44,7 @@ void screen_print_at(
   const screen_position_t column, const screen_position_t row,
   const byte_t attributes);
 void screen_print(const char * const message, const byte_t attributes);
+void screen_print_hex(const dword_t value, const byte_t attributes);
 void screen_clear();
 
 #endif
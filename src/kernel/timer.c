@@ -0,0 +1,51 @@
+/* Copyright (c) 2018, Juan Cruz Viotti
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *     # derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "timer.h"
+
+// PIT I/O ports
+static const port_t REGISTRY_TIMER_CHANNEL_0 = 0x40;
+static const port_t REGISTRY_TIMER_COMMAND = 0x43;
+
+// Select channel 0, access the counter as low byte followed by
+// high byte, and use mode 0 ("interrupt on terminal count"), which
+// raises the output once when the counter reaches zero and then
+// stays there, as opposed to the BIOS' periodic square wave (mode 3)
+static const byte_t TIMER_COMMAND_ONESHOT = 0x30;
+
+void timer_stop()
+{
+  // Writing the mode 0 command word drives the output low and stops
+  // the counter until a new count is loaded, which disarms the timer
+  port_byte_out(REGISTRY_TIMER_COMMAND, TIMER_COMMAND_ONESHOT);
+}
+
+void timer_oneshot(const word_t ticks)
+{
+  port_byte_out(REGISTRY_TIMER_COMMAND, TIMER_COMMAND_ONESHOT);
+  port_byte_out(REGISTRY_TIMER_CHANNEL_0, (byte_t) (ticks & 0xff));
+  port_byte_out(REGISTRY_TIMER_CHANNEL_0, (byte_t) (ticks >> 8));
+}
@@ -0,0 +1,56 @@
+#ifndef KERNEL_TIMER_H
+#define KERNEL_TIMER_H
+
+/* Copyright (c) 2018, Juan Cruz Viotti
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *     # derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "port.h"
+#include "types.h"
+
+/**
+ * A driver for channel 0 of the Programmable Interval Timer (PIT).
+ *
+ * The BIOS leaves this channel firing periodically at ~18.2 Hz. We
+ * don't want a periodic tick: the timer should only fire when there
+ * is a pending deadline, so an idle system can sleep on HLT without
+ * being woken up for nothing ("tickless" mode).
+ */
+
+// The frequency of the oscillator feeding the PIT, in Hz
+#define TIMER_FREQUENCY 1193182
+
+/**
+ * Stop the periodic tick. The timer won't fire again
+ * until a deadline is armed with timer_oneshot()
+ */
+void timer_stop();
+
+/**
+ * Fire the timer once after the given number of PIT ticks
+ */
+void timer_oneshot(const word_t ticks);
+
+#endif
@@ -33,5 +33,6 @@
 
 typedef unsigned char byte_t;
 typedef unsigned short word_t;
+typedef unsigned int dword_t;
 
 #endif
@@ -0,0 +1,272 @@
+/* Copyright (c) 2018, Juan Cruz Viotti
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *     # derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "virtio_blk.h"
+
+#define MIN(a, b) (((a) < (b)) ? (a) : (b))
+
+// Legacy virtio PCI ids
+static const word_t VIRTIO_VENDOR_ID = 0x1af4;
+static const word_t VIRTIO_BLK_DEVICE_ID = 0x1001;
+
+// Legacy virtio registers, relative to the I/O BAR
+static const port_t REGISTRY_VIRTIO_GUEST_FEATURES = 0x04;
+static const port_t REGISTRY_VIRTIO_QUEUE_ADDRESS = 0x08;
+static const port_t REGISTRY_VIRTIO_QUEUE_SIZE = 0x0c;
+static const port_t REGISTRY_VIRTIO_QUEUE_SELECT = 0x0e;
+static const port_t REGISTRY_VIRTIO_QUEUE_NOTIFY = 0x10;
+static const port_t REGISTRY_VIRTIO_DEVICE_STATUS = 0x12;
+static const port_t REGISTRY_VIRTIO_BLK_CAPACITY = 0x14;
+
+// Device status bits
+static const byte_t VIRTIO_STATUS_ACKNOWLEDGE = 0x1;
+static const byte_t VIRTIO_STATUS_DRIVER = 0x2;
+static const byte_t VIRTIO_STATUS_DRIVER_OK = 0x4;
+static const byte_t VIRTIO_STATUS_FAILED = 0x80;
+
+// Request status values
+static const byte_t VIRTIO_BLK_STATUS_OK = 0;
+static const byte_t VIRTIO_BLK_STATUS_PENDING = 0xff;
+
+// Every request takes a chain of this many descriptors
+static const int32_t VIRTIO_BLK_REQUEST_DESCRIPTORS = 3;
+
+// Prevent the compiler from moving memory accesses across this
+// point. x86 doesn't reorder stores with other stores, nor loads
+// with other loads, so this is enough to order two stores, or two
+// loads, as the device observes them
+static inline void __virtio_blk_barrier()
+{
+  __asm__ __volatile__("" : : : "memory");
+}
+
+// x86 does let a load go ahead of an earlier store to a different
+// address, so a store followed by a load needs a real fence
+static inline void __virtio_blk_fence()
+{
+  __asm__ __volatile__("lock; addl $0, (%%esp)" : : : "memory");
+}
+
+static uint64_t __virtio_blk_address(const volatile void * const pointer)
+{
+  return (uint64_t) (uintptr_t) pointer;
+}
+
+static void __virtio_blk_status(
+  const virtio_blk_device_t * const device, const byte_t status)
+{
+  port_byte_out((port_t) (device->io + REGISTRY_VIRTIO_DEVICE_STATUS), status);
+}
+
+// Link the descriptors of every request slot. The chains never
+// change, so submitting a request only fills in the data buffer
+static void __virtio_blk_chain_init(virtio_blk_device_t * const device)
+{
+  int32_t slot;
+  for (slot = 0; slot < device->depth; slot++)
+  {
+    const int32_t head = slot * VIRTIO_BLK_REQUEST_DESCRIPTORS;
+    virtqueue_descriptor_t * const chain = device->queue.descriptors + head;
+
+    chain[0].address = __virtio_blk_address(device->headers + slot);
+    chain[0].length = sizeof(virtio_blk_header_t);
+    chain[0].flags = VIRTQUEUE_DESCRIPTOR_NEXT;
+    chain[0].next = (word_t) (head + 1);
+
+    chain[1].flags = VIRTQUEUE_DESCRIPTOR_NEXT;
+    chain[1].next = (word_t) (head + 2);
+
+    chain[2].address = __virtio_blk_address(device->statuses + slot);
+    chain[2].length = sizeof(byte_t);
+    chain[2].flags = VIRTQUEUE_DESCRIPTOR_WRITE;
+
+    device->free_slots[slot] = (byte_t) slot;
+  }
+
+  device->free_count = device->depth;
+}
+
+// Impure
+int32_t virtio_blk_init(virtio_blk_device_t * const device)
+{
+  pci_device_t pci;
+  if (pci_find_device(VIRTIO_VENDOR_ID, VIRTIO_BLK_DEVICE_ID, &pci) == 0)
+  {
+    return 0;
+  }
+
+  // Legacy devices expose their registers through an I/O BAR. We
+  // also need bus mastering, as the device reads and writes the
+  // rings and buffers directly from memory
+  const dword_t bar = pci_config_read_dword(pci, PCI_CONFIG_BAR0);
+  if ((bar & PCI_BAR_IO_SPACE) == 0)
+  {
+    return 0;
+  }
+
+  device->io = (port_t) (bar & ~0x3u);
+  pci_config_write_word(pci, PCI_CONFIG_COMMAND, (word_t) (
+    pci_config_read_word(pci, PCI_CONFIG_COMMAND)
+    | PCI_COMMAND_IO_SPACE | PCI_COMMAND_BUS_MASTER));
+
+  // Reset the device, and tell it that we know how to drive it
+  __virtio_blk_status(device, 0);
+  __virtio_blk_status(device, VIRTIO_STATUS_ACKNOWLEDGE);
+  __virtio_blk_status(device, VIRTIO_STATUS_ACKNOWLEDGE | VIRTIO_STATUS_DRIVER);
+
+  // We don't need any optional feature
+  port_dword_out((port_t) (device->io + REGISTRY_VIRTIO_GUEST_FEATURES), 0);
+
+  // Legacy devices dictate the size of the queue
+  port_word_out((port_t) (device->io + REGISTRY_VIRTIO_QUEUE_SELECT), 0);
+  const word_t size =
+    port_word_in((port_t) (device->io + REGISTRY_VIRTIO_QUEUE_SIZE));
+  if (size < VIRTIO_BLK_REQUEST_DESCRIPTORS)
+  {
+    __virtio_blk_status(device, VIRTIO_STATUS_FAILED);
+    return 0;
+  }
+
+  // The queue, plus a header and a status byte per request slot,
+  // must fit in our region, or we would overwrite whatever follows
+  byte_t * const memory = (byte_t *) VIRTIO_BLK_MEMORY_ADDRESS;
+  const int32_t queue_memory_size = virtqueue_memory_size(size);
+  device->depth = MIN(VIRTIO_BLK_MAX_DEPTH, size / VIRTIO_BLK_REQUEST_DESCRIPTORS);
+  const int32_t memory_size = queue_memory_size
+    + device->depth * (int32_t) (sizeof(virtio_blk_header_t) + sizeof(byte_t));
+  if (memory_size > VIRTIO_BLK_MEMORY_SIZE)
+  {
+    __virtio_blk_status(device, VIRTIO_STATUS_FAILED);
+    return 0;
+  }
+
+  device->headers = (virtio_blk_header_t *) (memory + queue_memory_size);
+  device->statuses = (volatile byte_t *) (device->headers + device->depth);
+  memory_set(memory, 0, memory_size);
+
+  virtqueue_init(&device->queue, memory, size);
+  device->available_index = 0;
+  device->used_index = 0;
+  device->errors = 0;
+  __virtio_blk_chain_init(device);
+
+  // We poll for completions
+  device->queue.available->flags = VIRTQUEUE_AVAILABLE_NO_INTERRUPT;
+
+  // The device takes the page number of the queue
+  port_dword_out((port_t) (device->io + REGISTRY_VIRTIO_QUEUE_ADDRESS),
+    (dword_t) ((uintptr_t) memory / VIRTQUEUE_ALIGNMENT));
+
+  const port_t capacity = (port_t) (device->io + REGISTRY_VIRTIO_BLK_CAPACITY);
+  device->capacity = (uint64_t) port_dword_in(capacity)
+    | ((uint64_t) port_dword_in((port_t) (capacity + 4)) << 32);
+
+  __virtio_blk_status(device,
+    VIRTIO_STATUS_ACKNOWLEDGE | VIRTIO_STATUS_DRIVER | VIRTIO_STATUS_DRIVER_OK);
+  return 1;
+}
+
+// Impure
+int32_t virtio_blk_submit(
+  virtio_blk_device_t * const device,
+  const virtio_blk_request_t * const requests,
+  const int32_t count)
+{
+  const int32_t queued = MIN(count, device->free_count);
+  int32_t index;
+
+  for (index = 0; index < queued; index++)
+  {
+    const virtio_blk_request_t * const request = requests + index;
+    const int32_t slot = device->free_slots[--device->free_count];
+    const int32_t head = slot * VIRTIO_BLK_REQUEST_DESCRIPTORS;
+    virtqueue_descriptor_t * const data = device->queue.descriptors + head + 1;
+
+    device->headers[slot].type = request->type;
+    device->headers[slot].sector = request->sector;
+    device->statuses[slot] = VIRTIO_BLK_STATUS_PENDING;
+
+    data->address = __virtio_blk_address(request->buffer);
+    data->length = request->sectors * VIRTIO_BLK_SECTOR_SIZE;
+    data->flags = request->type == VIRTIO_BLK_TYPE_IN
+      ? VIRTQUEUE_DESCRIPTOR_NEXT | VIRTQUEUE_DESCRIPTOR_WRITE
+      : VIRTQUEUE_DESCRIPTOR_NEXT;
+
+    device->queue.available->ring[
+      (device->available_index + index) % device->queue.size] = (word_t) head;
+  }
+
+  if (queued == 0)
+  {
+    return 0;
+  }
+
+  // Publish the whole batch at once. The device must see the ring
+  // entries before the new index
+  __virtio_blk_barrier();
+  device->available_index = (word_t) (device->available_index + queued);
+  device->queue.available->index = device->available_index;
+
+  // The new index must be visible before we check whether the device
+  // wants a notification. Otherwise we might read a stale NO_NOTIFY
+  // from a device that then never sees the new requests
+  __virtio_blk_fence();
+
+  if ((device->queue.used->flags & VIRTQUEUE_USED_NO_NOTIFY) == 0)
+  {
+    port_word_out((port_t) (device->io + REGISTRY_VIRTIO_QUEUE_NOTIFY), 0);
+  }
+
+  return queued;
+}
+
+// Impure
+int32_t virtio_blk_poll(virtio_blk_device_t * const device)
+{
+  const word_t used_index = device->queue.used->index;
+  int32_t completed = 0;
+
+  // Don't read the ring entries before the index that covers them
+  __virtio_blk_barrier();
+
+  while (device->used_index != used_index)
+  {
+    const dword_t head =
+      device->queue.used->ring[device->used_index % device->queue.size].id;
+    const int32_t slot = (int32_t) head / VIRTIO_BLK_REQUEST_DESCRIPTORS;
+
+    if (device->statuses[slot] != VIRTIO_BLK_STATUS_OK)
+    {
+      device->errors++;
+    }
+
+    device->free_slots[device->free_count++] = (byte_t) slot;
+    device->used_index++;
+    completed++;
+  }
+
+  return completed;
+}
@@ -0,0 +1,124 @@
+#ifndef KERNEL_VIRTIO_BLK_H
+#define KERNEL_VIRTIO_BLK_H
+
+/* Copyright (c) 2018, Juan Cruz Viotti
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *     # derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdint.h>
+#include "pci.h"
+#include "port.h"
+#include "types.h"
+#include "memory.h"
+#include "virtqueue.h"
+
+/**
+ * A polling driver for legacy virtio block devices on the PCI bus,
+ * such as the ones QEMU creates with "-drive if=virtio".
+ *
+ * Every request takes a fixed chain of three descriptors: the request
+ * header, the data buffer, and the status byte. Requests are queued in
+ * batches, and the device is notified once per batch.
+ */
+
+#define VIRTIO_BLK_SECTOR_SIZE 512
+
+// Request types
+#define VIRTIO_BLK_TYPE_IN 0
+#define VIRTIO_BLK_TYPE_OUT 1
+
+// The maximum number of requests in flight
+#define VIRTIO_BLK_MAX_DEPTH 64
+
+// Where the virtqueue and the request headers live. Segments are
+// flat and there is no paging, so addresses are also the physical
+// addresses that the device accesses. This is free conventional
+// memory, below the protected mode stack
+#define VIRTIO_BLK_MEMORY_ADDRESS 0x10000
+
+// How much memory the driver may use from VIRTIO_BLK_MEMORY_ADDRESS
+#define VIRTIO_BLK_MEMORY_SIZE 0x10000
+
+typedef struct virtio_blk_header
+{
+  dword_t type;
+  dword_t reserved;
+  uint64_t sector;
+} virtio_blk_header_t;
+
+typedef struct virtio_blk_request
+{
+  dword_t type;
+  uint64_t sector;
+  byte_t * buffer;
+  dword_t sectors;
+} virtio_blk_request_t;
+
+typedef struct virtio_blk_device
+{
+  port_t io;
+  uint64_t capacity;
+  virtqueue_t queue;
+
+  // Our copy of the available ring index, and the
+  // last used ring index that we have seen
+  word_t available_index;
+  word_t used_index;
+
+  // Per request slot headers and status bytes
+  virtio_blk_header_t * headers;
+  volatile byte_t * statuses;
+
+  // A stack of the request slots that are not in flight
+  byte_t free_slots[VIRTIO_BLK_MAX_DEPTH];
+  int32_t free_count;
+  int32_t depth;
+
+  // The number of completed requests that failed
+  int32_t errors;
+} virtio_blk_device_t;
+
+/**
+ * Find and initialise the first virtio block device.
+ * Returns 1 on success, or 0 if there is no usable device
+ */
+int32_t virtio_blk_init(virtio_blk_device_t * const device);
+
+/**
+ * Queue as many of the given requests as there are free slots,
+ * and notify the device once. Returns the number of queued requests
+ */
+int32_t virtio_blk_submit(
+  virtio_blk_device_t * const device,
+  const virtio_blk_request_t * const requests,
+  const int32_t count);
+
+/**
+ * Reap the requests completed since the last call, without
+ * waiting. Returns the number of completed requests
+ */
+int32_t virtio_blk_poll(virtio_blk_device_t * const device);
+
+#endif
@@ -0,0 +1,64 @@
+/* Copyright (c) 2018, Juan Cruz Viotti
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *     # derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "virtqueue.h"
+
+static int32_t __virtqueue_align(const int32_t bytes)
+{
+  return (bytes + VIRTQUEUE_ALIGNMENT - 1) & ~(VIRTQUEUE_ALIGNMENT - 1);
+}
+
+int32_t virtqueue_available_offset(const word_t size)
+{
+  return (int32_t) sizeof(virtqueue_descriptor_t) * size;
+}
+
+int32_t virtqueue_used_offset(const word_t size)
+{
+  // The flags, the index, one entry per descriptor,
+  // and the trailing "used_event" word
+  return __virtqueue_align(virtqueue_available_offset(size)
+    + (int32_t) sizeof(word_t) * (3 + size));
+}
+
+int32_t virtqueue_memory_size(const word_t size)
+{
+  // The flags, the index, one element per descriptor,
+  // and the trailing "avail_event" word
+  return virtqueue_used_offset(size) + __virtqueue_align(
+    (int32_t) sizeof(word_t) * 3
+    + (int32_t) sizeof(virtqueue_used_element_t) * size);
+}
+
+void virtqueue_init(
+  virtqueue_t * const queue, byte_t * const address, const word_t size)
+{
+  queue->size = size;
+  queue->descriptors = (virtqueue_descriptor_t *) address;
+  queue->available =
+    (virtqueue_available_t *) (address + virtqueue_available_offset(size));
+  queue->used = (volatile virtqueue_used_t *) (address + virtqueue_used_offset(size));
+}
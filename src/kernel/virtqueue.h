@@ -0,0 +1,112 @@
+#ifndef KERNEL_VIRTQUEUE_H
+#define KERNEL_VIRTQUEUE_H
+
+/* Copyright (c) 2018, Juan Cruz Viotti
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *     # derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdint.h>
+#include "types.h"
+
+/**
+ * Split virtqueues, as laid out by legacy (pre 1.0) virtio devices.
+ *
+ * A virtqueue consists of three areas living in guest memory: a
+ * descriptor table pointing at the buffers, an "available" ring where
+ * the driver publishes descriptor chains, and a "used" ring where the
+ * device returns them once processed. Legacy devices expect the three
+ * areas to be contiguous, with the used ring starting on its own page.
+ */
+
+#define VIRTQUEUE_ALIGNMENT 4096
+
+// Descriptor flags
+#define VIRTQUEUE_DESCRIPTOR_NEXT 0x1
+#define VIRTQUEUE_DESCRIPTOR_WRITE 0x2
+
+// Ask the device not to interrupt us when it uses a buffer
+#define VIRTQUEUE_AVAILABLE_NO_INTERRUPT 0x1
+
+// Set by the device when it doesn't need to be notified
+#define VIRTQUEUE_USED_NO_NOTIFY 0x1
+
+typedef struct virtqueue_descriptor
+{
+  uint64_t address;
+  dword_t length;
+  word_t flags;
+  word_t next;
+} virtqueue_descriptor_t;
+
+typedef struct virtqueue_available
+{
+  word_t flags;
+  word_t index;
+  word_t ring[];
+} virtqueue_available_t;
+
+typedef struct virtqueue_used_element
+{
+  dword_t id;
+  dword_t length;
+} virtqueue_used_element_t;
+
+typedef struct virtqueue_used
+{
+  word_t flags;
+  word_t index;
+  virtqueue_used_element_t ring[];
+} virtqueue_used_t;
+
+typedef struct virtqueue
+{
+  word_t size;
+  virtqueue_descriptor_t * descriptors;
+  virtqueue_available_t * available;
+  volatile virtqueue_used_t * used;
+} virtqueue_t;
+
+/**
+ * Get the offset of the available ring from the start of a queue
+ */
+int32_t virtqueue_available_offset(const word_t size);
+
+/**
+ * Get the offset of the used ring from the start of a queue
+ */
+int32_t virtqueue_used_offset(const word_t size);
+
+/**
+ * Get the amount of memory taken by a queue, including padding
+ */
+int32_t virtqueue_memory_size(const word_t size);
+
+/**
+ * Point a queue at its (zeroed, page aligned) memory
+ */
+void virtqueue_init(
+  virtqueue_t * const queue, byte_t * const address, const word_t size);
+
+#endif
@@ -0,0 +1,87 @@
+/* Copyright (c) 2018, Juan Cruz Viotti
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *     # derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <unity.h>
+#include "src/kernel/multiboot.h"
+
+static multiboot_memory_map_entry_t memory_map[3];
+
+static void set_entry(
+  const int32_t index, const uint64_t address,
+  const uint64_t length, const dword_t type)
+{
+  memory_map[index].size = sizeof(multiboot_memory_map_entry_t) - sizeof(dword_t);
+  memory_map[index].address = address;
+  memory_map[index].length = length;
+  memory_map[index].type = type;
+}
+
+void test_multiboot_memory_map_available_empty()
+{
+  TEST_ASSERT_EQUAL_HEX32(0, multiboot_memory_map_available((byte_t *) memory_map, 0));
+}
+
+void test_multiboot_memory_map_available_one_entry()
+{
+  set_entry(0, 0x0, 0x9fc00, MULTIBOOT_MEMORY_AVAILABLE);
+  TEST_ASSERT_EQUAL_HEX32(0x27f, multiboot_memory_map_available(
+    (byte_t *) memory_map, sizeof(multiboot_memory_map_entry_t)));
+}
+
+void test_multiboot_memory_map_available_skips_reserved()
+{
+  set_entry(0, 0x0, 0x9fc00, MULTIBOOT_MEMORY_AVAILABLE);
+  set_entry(1, 0x9fc00, 0x400, 2);
+  set_entry(2, 0x100000, 0x7ee0000, MULTIBOOT_MEMORY_AVAILABLE);
+  TEST_ASSERT_EQUAL_HEX32(0x27f + 0x1fb80, multiboot_memory_map_available(
+    (byte_t *) memory_map, sizeof(memory_map)));
+}
+
+void test_multiboot_memory_map_available_above_4_gib()
+{
+  set_entry(0, 0x100000000, 0x100000000, MULTIBOOT_MEMORY_AVAILABLE);
+  TEST_ASSERT_EQUAL_HEX32(0x400000, multiboot_memory_map_available(
+    (byte_t *) memory_map, sizeof(multiboot_memory_map_entry_t)));
+}
+
+void test_multiboot_memory_map_available_truncated()
+{
+  set_entry(0, 0x0, 0x9fc00, MULTIBOOT_MEMORY_AVAILABLE);
+  set_entry(1, 0x100000, 0x7ee0000, MULTIBOOT_MEMORY_AVAILABLE);
+  TEST_ASSERT_EQUAL_HEX32(0x27f, multiboot_memory_map_available(
+    (byte_t *) memory_map, sizeof(multiboot_memory_map_entry_t) + 4));
+}
+
+int main()
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_multiboot_memory_map_available_empty);
+  RUN_TEST(test_multiboot_memory_map_available_one_entry);
+  RUN_TEST(test_multiboot_memory_map_available_skips_reserved);
+  RUN_TEST(test_multiboot_memory_map_available_above_4_gib);
+  RUN_TEST(test_multiboot_memory_map_available_truncated);
+  return UNITY_END();
+}
@@ -0,0 +1,77 @@
+/* Copyright (c) 2018, Juan Cruz Viotti
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *     # derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <unity.h>
+#include "src/kernel/profiler.h"
+
+void test_profiler_bucket_text_address()
+{
+  TEST_ASSERT_EQUAL_INT(0, profiler_bucket(0x1000, 0x1000));
+}
+
+void test_profiler_bucket_same_bucket()
+{
+  TEST_ASSERT_EQUAL_INT(0, profiler_bucket(0x1000, 0x1000 + PROFILER_BUCKET_SIZE - 1));
+}
+
+void test_profiler_bucket_next_bucket()
+{
+  TEST_ASSERT_EQUAL_INT(1, profiler_bucket(0x1000, 0x1000 + PROFILER_BUCKET_SIZE));
+}
+
+void test_profiler_bucket_last_bucket()
+{
+  TEST_ASSERT_EQUAL_INT(PROFILER_BUCKETS - 1,
+    profiler_bucket(0x1000, 0x1000 + PROFILER_TEXT_SIZE - 1));
+}
+
+void test_profiler_bucket_below_text()
+{
+  TEST_ASSERT_EQUAL_INT(-1, profiler_bucket(0x1000, 0xfff));
+}
+
+void test_profiler_bucket_above_text()
+{
+  TEST_ASSERT_EQUAL_INT(-1, profiler_bucket(0x1000, 0x1000 + PROFILER_TEXT_SIZE));
+}
+
+void test_profiler_bucket_boot_loader()
+{
+  TEST_ASSERT_EQUAL_INT(-1, profiler_bucket(0x1000, 0x7c00));
+}
+
+int main()
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_profiler_bucket_text_address);
+  RUN_TEST(test_profiler_bucket_same_bucket);
+  RUN_TEST(test_profiler_bucket_next_bucket);
+  RUN_TEST(test_profiler_bucket_last_bucket);
+  RUN_TEST(test_profiler_bucket_below_text);
+  RUN_TEST(test_profiler_bucket_above_text);
+  RUN_TEST(test_profiler_bucket_boot_loader);
+  return UNITY_END();
+}
@@ -0,0 +1,96 @@
+/* Copyright (c) 2018, Juan Cruz Viotti
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *     # derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <unity.h>
+#include "src/kernel/virtqueue.h"
+
+void test_virtqueue_available_offset_256()
+{
+  TEST_ASSERT_EQUAL_HEX32(0x1000, virtqueue_available_offset(256));
+}
+
+void test_virtqueue_used_offset_256()
+{
+  // 4096 bytes of descriptors plus 518 bytes of available ring
+  TEST_ASSERT_EQUAL_HEX32(0x2000, virtqueue_used_offset(256));
+}
+
+void test_virtqueue_memory_size_256()
+{
+  TEST_ASSERT_EQUAL_HEX32(0x3000, virtqueue_memory_size(256));
+}
+
+void test_virtqueue_used_offset_128()
+{
+  // 2048 bytes of descriptors plus 262 bytes of available ring
+  TEST_ASSERT_EQUAL_HEX32(0x1000, virtqueue_used_offset(128));
+}
+
+void test_virtqueue_memory_size_128()
+{
+  TEST_ASSERT_EQUAL_HEX32(0x2000, virtqueue_memory_size(128));
+}
+
+void test_virtqueue_memory_size_1024()
+{
+  // 16384 bytes of descriptors plus 2054 bytes of available ring,
+  // and 8198 bytes of used ring
+  TEST_ASSERT_EQUAL_HEX32(0x8000, virtqueue_memory_size(1024));
+}
+
+void test_virtqueue_used_offset_aligned()
+{
+  for (word_t size = 1; size <= 1024; size++)
+  {
+    TEST_ASSERT_EQUAL_HEX32(0, virtqueue_used_offset(size) % VIRTQUEUE_ALIGNMENT);
+    TEST_ASSERT_EQUAL_HEX32(0, virtqueue_memory_size(size) % VIRTQUEUE_ALIGNMENT);
+  }
+}
+
+void test_virtqueue_init_256()
+{
+  static byte_t memory[0x3000];
+  virtqueue_t queue;
+  virtqueue_init(&queue, memory, 256);
+  TEST_ASSERT_EQUAL_INT(256, queue.size);
+  TEST_ASSERT_EQUAL_PTR(memory, queue.descriptors);
+  TEST_ASSERT_EQUAL_PTR(memory + 0x1000, queue.available);
+  TEST_ASSERT_EQUAL_PTR(memory + 0x2000, queue.used);
+}
+
+int main()
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_virtqueue_available_offset_256);
+  RUN_TEST(test_virtqueue_used_offset_256);
+  RUN_TEST(test_virtqueue_memory_size_256);
+  RUN_TEST(test_virtqueue_used_offset_128);
+  RUN_TEST(test_virtqueue_memory_size_128);
+  RUN_TEST(test_virtqueue_memory_size_1024);
+  RUN_TEST(test_virtqueue_used_offset_aligned);
+  RUN_TEST(test_virtqueue_init_256);
+  return UNITY_END();
+}
@@ -0,0 +1,68 @@
+#!/bin/sh
+
+set -e
+KERNEL="$1"
+PROFILE="$2"
+set -u
+
+if [ -z "$KERNEL" ] || [ -z "$PROFILE" ]; then
+  echo "Usage: $0 <kernel elf> <profile>" >&2
+  exit 1
+fi
+
+NM="${NM:-nm}"
+
+# Attribute every histogram bucket dumped by the kernel profiler to
+# the closest code symbol at or below its address, and print a flat
+# profile sorted by the number of samples
+"$NM" -n "$KERNEL" | awk '
+  function hex(string,    value, index_, digit) {
+    sub(/^0x/, "", string)
+    value = 0
+    for (index_ = 1; index_ <= length(string); index_++) {
+      digit = index("0123456789abcdef", tolower(substr(string, index_, 1)))
+      value = value * 16 + digit - 1
+    }
+    return value
+  }
+
+  # The symbols, sorted by address
+  FILENAME == "-" {
+    if ($2 ~ /^[tT]$/) {
+      symbols++
+      symbol_address[symbols] = hex($1)
+      symbol_name[symbols] = $3
+    }
+    next
+  }
+
+  $1 == "profile" || $1 == "outside" {
+    if ($1 == "outside") {
+      samples["[outside]"] += hex($2)
+      total += hex($2)
+    }
+    next
+  }
+
+  {
+    address = hex($1)
+    name = "[unknown]"
+    for (index_ = symbols; index_ > 0; index_--) {
+      if (symbol_address[index_] <= address) {
+        name = symbol_name[index_]
+        break
+      }
+    }
+
+    samples[name] += hex($2)
+    total += hex($2)
+  }
+
+  END {
+    for (name in samples) {
+      if (samples[name] > 0) {
+        printf "%8d %6.2f%% %s\n", samples[name], 100 * samples[name] / total, name
+      }
+    }
+  }
+' - "$PROFILE" | sort -rn